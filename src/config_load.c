@@ -9,6 +9,8 @@ int CONFIG_JSON_OUTPUT_ITEMINFO = 0;
 int CONFIG_JSON_OUTPUT_TYPE = 0;
 int CONFIG_JSON_OUTPUT_SEP_DATE = 0;
 int CONFIG_JSON_OUTPUT_SEP_TYPE = 0;
+int CONFIG_JSON_OUTPUT_DICTIONARY = 0;
+int CONFIG_JSON_OUTPUT_DICTIONARY_TTL = 600;
 
 
 /*********************************************************************
@@ -41,6 +43,10 @@ void     zbx_module_load_config(void)
 				PARM_OPT,		0,		1},
 		{"JSONOutputSeparateType",	&CONFIG_JSON_OUTPUT_SEP_TYPE,	TYPE_INT,
 				PARM_OPT,		0,		1},
+		{"JSONOutputItemDictionary",	&CONFIG_JSON_OUTPUT_DICTIONARY,	TYPE_INT,
+				PARM_OPT,		0,		1},
+		{"JSONOutputItemDictionaryTTL",	&CONFIG_JSON_OUTPUT_DICTIONARY_TTL,	TYPE_INT,
+				PARM_OPT,		1,		86400},
 		{NULL, NULL, 0, 0, 0, 0}
 	};
 
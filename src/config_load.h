@@ -29,6 +29,8 @@ extern int CONFIG_JSON_OUTPUT_ITEMINFO;
 extern int CONFIG_JSON_OUTPUT_SEP_DATE;
 extern int CONFIG_JSON_OUTPUT_SEP_TYPE;
 extern int CONFIG_JSON_OUTPUT_TYPE;
+extern int CONFIG_JSON_OUTPUT_DICTIONARY;
+extern int CONFIG_JSON_OUTPUT_DICTIONARY_TTL;
 
 
 #endif /* __ZABBIX_CONFIG_LOAD_H */
@@ -25,6 +25,7 @@
 #include "dbcache.h"
 
 #include "config_load.h"
+#include "item_dict.h"
 
 #define MODULE_NAME "history2json.so"
 
@@ -143,8 +144,9 @@ int	zbx_module_init(void)
 
 	zbx_module_load_config();
 
-	zabbix_log(LOG_LEVEL_WARNING, "[%s] config parameter enable:[%d], path:[%s]",
-	           MODULE_NAME, CONFIG_JSON_OUTPUT_ENABLE, CONFIG_JSON_OUTPUT_PATH);
+	zabbix_log(LOG_LEVEL_WARNING, "[%s] config parameter enable:[%d], path:[%s], dictionary:[%d], ttl:[%d]",
+	           MODULE_NAME, CONFIG_JSON_OUTPUT_ENABLE, CONFIG_JSON_OUTPUT_PATH,
+	           CONFIG_JSON_OUTPUT_DICTIONARY, CONFIG_JSON_OUTPUT_DICTIONARY_TTL);
 	return ret;
 }
 
@@ -161,6 +163,8 @@ int	zbx_module_init(void)
  ******************************************************************************/
 int	zbx_module_uninit(void)
 {
+	item_dict_destroy();
+
 	return ZBX_MODULE_OK;
 }
 
@@ -182,6 +186,8 @@ int	zbx_module_uninit(void)
 #define H2J_ITEM_TEXT 4
 #define H2J_ITEM_LOG 5
 
+#define H2J_JSON_TAG_DEFINITION "definition"
+
 static void	history2json_general_cb(const int item_type, const void *history, int history_num)
 {
 	int	i;
@@ -196,6 +202,11 @@ static void	history2json_general_cb(const int item_type, const void *history, in
 	char	*hostname = NULL;
 	int	hostid = 0;
 	char	*itemkey = NULL;
+	zbx_uint64_t	itemid = 0;
+	int	dict_slot = 0;
+	int	use_dict = FAIL;
+	int	define_item = FAIL;
+	time_t	now = 0;
 
 	time_t	t;
 	struct	tm tm_tmp;
@@ -295,7 +306,7 @@ static void	history2json_general_cb(const int item_type, const void *history, in
 
 	/* open file */
 	errno = 0;
-	if ( NULL == (f= fopen(filename, "a")) ){
+	if ( NULL == (f= fopen(filename, ITEM_DICT_FOPEN_MODE)) ){
 		zabbix_log(LOG_LEVEL_WARNING, "[%s] In %s() %s:%d Error in open file \"%s\" disable it. [%s]",
 		           MODULE_NAME, __FUNCTION__, __FILE__, __LINE__, filename, zbx_strerror(errno) );
 		CONFIG_JSON_OUTPUT_ENABLE = CONFIG_DISABLE;
@@ -308,9 +319,43 @@ static void	history2json_general_cb(const int item_type, const void *history, in
 		goto quit;
 	}
 
+	// with the item dictionary, host/item infomation is written once per file.
+	if( CONFIG_ENABLE == CONFIG_JSON_OUTPUT_DICTIONARY &&
+	    ( CONFIG_ENABLE == CONFIG_JSON_OUTPUT_HOSTINFO || CONFIG_ENABLE == CONFIG_JSON_OUTPUT_ITEMINFO ||
+	      CONFIG_ENABLE == CONFIG_JSON_OUTPUT_TYPE ) ){
+		use_dict = SUCCEED;
+		dict_slot = ( CONFIG_ENABLE == CONFIG_JSON_OUTPUT_SEP_TYPE ) ? item_type : 0;
+		now = time(NULL);
+		item_dict_sync(dict_slot, filename, f);
+	}
+
 	for (i = 0; i < history_num; i++){
 
-		if( CONFIG_ENABLE == CONFIG_JSON_OUTPUT_HOSTINFO ){
+		switch(item_type){
+			case  H2J_ITEM_FLOAT:
+				itemid = history_float[i].itemid;
+				break;
+			case  H2J_ITEM_INTEGER:
+				itemid = history_integer[i].itemid;
+				break;
+			case  H2J_ITEM_STRING:
+				itemid = history_string[i].itemid;
+				break;
+			case  H2J_ITEM_TEXT:
+				itemid = history_text[i].itemid;
+				break;
+			case  H2J_ITEM_LOG:
+				itemid = history_log[i].itemid;
+				break;
+			default:
+				THIS_SHOULD_NEVER_HAPPEN;
+		}
+
+		if( SUCCEED == use_dict ){
+			define_item = ( SUCCEED == item_dict_exists(dict_slot, itemid, item_type, now) ) ? FAIL : SUCCEED;
+		}
+
+		if( CONFIG_ENABLE == CONFIG_JSON_OUTPUT_HOSTINFO && ( FAIL == use_dict || SUCCEED == define_item ) ){
 			// Get hostname from item id
 			switch(item_type){
 				case  H2J_ITEM_FLOAT:
@@ -344,7 +389,7 @@ static void	history2json_general_cb(const int item_type, const void *history, in
 			}
 		}
 
-		if( CONFIG_ENABLE == CONFIG_JSON_OUTPUT_ITEMINFO ){
+		if( CONFIG_ENABLE == CONFIG_JSON_OUTPUT_ITEMINFO && ( FAIL == use_dict || SUCCEED == define_item ) ){
 			// Get item key from item id
 			switch(item_type){
 				case  H2J_ITEM_FLOAT:
@@ -373,6 +418,42 @@ static void	history2json_general_cb(const int item_type, const void *history, in
 				itemkey = NULL;
 			}else{
 				itemkey = zbx_strdup(itemkey, items.key_orig );
+				DCconfig_clean_items( &items, &err, 1);
+			}
+		}
+
+		// Packing item definition to json format, ahead of its first value in this file
+		if( SUCCEED == define_item ){
+			zbx_json_init(&j, ZBX_JSON_STAT_BUF_LEN);
+			zbx_json_addobject(&j, H2J_JSON_TAG_DEFINITION);
+			zbx_json_adduint64(&j, ZBX_PROTO_TAG_ITEMID, itemid);
+
+			if( CONFIG_ENABLE == CONFIG_JSON_OUTPUT_HOSTINFO ){
+				zbx_json_adduint64(&j, ZBX_PROTO_TAG_HOSTID, hostid);
+				zbx_json_addstring(&j, ZBX_PROTO_TAG_HOST, hostname, ZBX_JSON_TYPE_STRING);
+			}
+			if( CONFIG_ENABLE == CONFIG_JSON_OUTPUT_TYPE ){
+				zbx_json_addstring(&j, ZBX_PROTO_TAG_TYPE, item_type_str[item_type], ZBX_JSON_TYPE_STRING);
+			}
+			if( CONFIG_ENABLE == CONFIG_JSON_OUTPUT_ITEMINFO ){
+				zbx_json_addstring(&j, ZBX_PROTO_TAG_KEY, itemkey, ZBX_JSON_TYPE_STRING);
+			}
+
+			zbx_json_close(&j);
+			zbx_json_close(&j);
+
+			zabbix_log(LOG_LEVEL_DEBUG, "[%s] In %s() %s:%d JSON output \"%s\"",
+			           MODULE_NAME, __FUNCTION__, __FILE__, __LINE__,
+			           j.buffer );
+
+			fprintf(f, "%s\n", j.buffer );
+
+			zbx_json_free(&j);
+
+			// a failed lookup is not remembered, so that it is tried again next time
+			if( ( CONFIG_DISABLE == CONFIG_JSON_OUTPUT_HOSTINFO || NULL != hostname ) &&
+			    ( CONFIG_DISABLE == CONFIG_JSON_OUTPUT_ITEMINFO || NULL != itemkey ) ){
+				item_dict_add(dict_slot, itemid, item_type, now);
 			}
 		}
 
@@ -382,14 +463,14 @@ static void	history2json_general_cb(const int item_type, const void *history, in
 		if( CONFIG_ENABLE == CONFIG_JSON_OUTPUT_PID ){
 			zbx_json_adduint64(&j, "pid", getpid());
 		}
-		if( CONFIG_ENABLE == CONFIG_JSON_OUTPUT_HOSTINFO ){
+		if( FAIL == use_dict && CONFIG_ENABLE == CONFIG_JSON_OUTPUT_HOSTINFO ){
 			zbx_json_adduint64(&j, ZBX_PROTO_TAG_HOSTID, hostid);
 			zbx_json_addstring(&j, ZBX_PROTO_TAG_HOST, hostname, ZBX_JSON_TYPE_STRING);
 		}
-		if( CONFIG_ENABLE == CONFIG_JSON_OUTPUT_TYPE ){
+		if( FAIL == use_dict && CONFIG_ENABLE == CONFIG_JSON_OUTPUT_TYPE ){
 			zbx_json_addstring(&j, ZBX_PROTO_TAG_TYPE, item_type_str[item_type], ZBX_JSON_TYPE_STRING);
 		}
-		if( CONFIG_ENABLE == CONFIG_JSON_OUTPUT_ITEMINFO ){
+		if( FAIL == use_dict && CONFIG_ENABLE == CONFIG_JSON_OUTPUT_ITEMINFO ){
 			zbx_json_addstring(&j, ZBX_PROTO_TAG_KEY, itemkey, ZBX_JSON_TYPE_STRING);
 		}
 
@@ -445,7 +526,7 @@ static void	history2json_general_cb(const int item_type, const void *history, in
 		zbx_json_free(&j);
 		zbx_free(hostname);
 		zbx_free(itemkey);
-		DCconfig_clean_items( &items, &err, 1);
+		define_item = FAIL;
 	}
 
 
@@ -456,6 +537,13 @@ static void	history2json_general_cb(const int item_type, const void *history, in
 	if( 0 != fflush(f) ){
 		zabbix_log(LOG_LEVEL_WARNING, "[%s] In %s() %s:%d Error in fflush()",
 		           MODULE_NAME, __FUNCTION__, __FILE__, __LINE__ );
+
+		// definitions of this batch may be lost, write them again next time
+		if( SUCCEED == use_dict ){
+			item_dict_invalidate(dict_slot);
+		}
+	}else if( SUCCEED == use_dict ){
+		item_dict_written(dict_slot, f);
 	}
 
 	if( 0 != flock( fileno(f), LOCK_UN) ){
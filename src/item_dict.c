@@ -0,0 +1,223 @@
+
+#include "item_dict.h"
+#include "config_load.h"
+
+/* itemids already defined in the output file this slot last wrote to */
+typedef struct
+{
+	char		*filename;
+	dev_t		st_dev;
+	ino_t		st_ino;
+	off_t		size;
+	char		head[ITEM_DICT_HEAD_LEN];
+	size_t		head_len;
+	zbx_hashset_t	itemids;
+	int		created;
+}
+item_dict_t;
+
+/* itemid must be the first member, the hashset uses the uint64 functions */
+typedef struct
+{
+	zbx_uint64_t	itemid;
+	int		item_type;
+	time_t		defined;
+}
+item_dict_entry_t;
+
+static item_dict_t	item_dicts[ITEM_DICT_SLOT_NUM];
+
+
+/*********************************************************************
+ * item_dict_read_head                                               *
+ *   Read the first line of the file (at most "size" bytes), which   *
+ *   tells this file apart from an earlier one at the same inode.    *
+ *   Returns FAIL when the head could not be read.                   *
+ *********************************************************************/
+static int     item_dict_read_head(FILE *f, char *buf, size_t size, size_t *len)
+{
+	ssize_t	n;
+	char	*nl;
+
+	errno = 0;
+	if (0 >= (n = pread(fileno(f), buf, size, 0))){
+		zabbix_log(LOG_LEVEL_WARNING, "[%s] In %s() %s:%d Error in pread() [%s]",
+		           MODULE_NAME, __FUNCTION__, __FILE__, __LINE__,
+		           0 == n ? "empty file" : zbx_strerror(errno));
+		*len = 0;
+		return FAIL;
+	}
+
+	if (NULL != (nl = (char *)memchr(buf, '\n', (size_t)n)))
+		*len = (size_t)(nl - buf) + 1;
+	else
+		*len = (size_t)n;
+
+	return SUCCEED;
+}
+
+
+/*********************************************************************
+ * item_dict_write_head                                              *
+ *   Start an empty file with a header record unique to this write,  *
+ *   {"history2json":{"pid":..,"clock":..,"ns":..}}                  *
+ *********************************************************************/
+static size_t     item_dict_write_head(FILE *f, char *buf, size_t size)
+{
+	struct zbx_json		j;
+	zbx_timespec_t		ts;
+
+	zbx_timespec(&ts);
+
+	zbx_json_init(&j, ZBX_JSON_STAT_BUF_LEN);
+	zbx_json_addobject(&j, ITEM_DICT_TAG_HEAD);
+	zbx_json_adduint64(&j, "pid", getpid());
+	zbx_json_adduint64(&j, ZBX_PROTO_TAG_CLOCK, ts.sec);
+	zbx_json_adduint64(&j, ZBX_PROTO_TAG_NS, ts.ns);
+	zbx_json_close(&j);
+	zbx_json_close(&j);
+
+	fprintf(f, "%s\n", j.buffer);
+	zbx_snprintf(buf, size, "%s\n", j.buffer);
+
+	zbx_json_free(&j);
+
+	return strlen(buf);
+}
+
+
+/*********************************************************************
+ * item_dict_sync                                                    *
+ *   Reset the dictionary when "f" is not the same file written      *
+ *   last time: the name changed (date/type split), the file was     *
+ *   replaced (rotated), or it was truncated. Truncation is seen by  *
+ *   the header line, even when other history syncers have already   *
+ *   refilled the file past its old size (copytruncate).             *
+ *   Must be called with the file locked.                            *
+ *********************************************************************/
+void     item_dict_sync(int slot, const char *filename, FILE *f)
+{
+	item_dict_t	*dict = &item_dicts[slot];
+	struct stat	st;
+	char		head[ITEM_DICT_HEAD_LEN];
+	size_t		head_len = 0;
+
+	if (0 != fstat(fileno(f), &st)){
+		zabbix_log(LOG_LEVEL_WARNING, "[%s] In %s() %s:%d Error in fstat() [%s]",
+		           MODULE_NAME, __FUNCTION__, __FILE__, __LINE__, zbx_strerror(errno));
+		memset(&st, 0, sizeof(st));
+	}else if (0 == st.st_size){
+		head_len = item_dict_write_head(f, head, sizeof(head));
+	}else if (SUCCEED == item_dict_read_head(f, head, sizeof(head), &head_len)){
+		if (0 != dict->created && NULL != dict->filename && 0 == strcmp(dict->filename, filename) &&
+		    st.st_dev == dict->st_dev && st.st_ino == dict->st_ino && st.st_size >= dict->size &&
+		    head_len == dict->head_len && 0 == memcmp(head, dict->head, head_len)){
+			return;
+		}
+	}
+
+	/* an unreadable head is taken as a new file, definitions are written again */
+	zabbix_log(LOG_LEVEL_DEBUG, "[%s] In %s() %s:%d reset item dictionary for \"%s\"",
+	           MODULE_NAME, __FUNCTION__, __FILE__, __LINE__, filename);
+
+	if (0 == dict->created){
+		zbx_hashset_create(&dict->itemids, 100,
+		                   ZBX_DEFAULT_UINT64_HASH_FUNC, ZBX_DEFAULT_UINT64_COMPARE_FUNC);
+		dict->created = 1;
+	}else{
+		zbx_hashset_clear(&dict->itemids);
+	}
+
+	dict->filename = zbx_strdup(dict->filename, filename);
+	dict->st_dev = st.st_dev;
+	dict->st_ino = st.st_ino;
+	dict->size = st.st_size;
+	memcpy(dict->head, head, head_len);
+	dict->head_len = head_len;
+}
+
+
+/*********************************************************************
+ * item_dict_exists                                                  *
+ *   An entry expires JSONOutputItemDictionaryTTL seconds after its  *
+ *   definition was written, so that host/item configuration changes *
+ *   are picked up by a new definition record. A value of another    *
+ *   type than defined (value type changed) needs a new one at once. *
+ *********************************************************************/
+int     item_dict_exists(int slot, zbx_uint64_t itemid, int item_type, time_t now)
+{
+	item_dict_entry_t	*entry;
+
+	if (NULL == (entry = (item_dict_entry_t *)zbx_hashset_search(&item_dicts[slot].itemids, &itemid)))
+		return FAIL;
+
+	if (item_type != entry->item_type)
+		return FAIL;
+
+	if (now - entry->defined >= CONFIG_JSON_OUTPUT_DICTIONARY_TTL || now < entry->defined)
+		return FAIL;
+
+	return SUCCEED;
+}
+
+
+void     item_dict_add(int slot, zbx_uint64_t itemid, int item_type, time_t now)
+{
+	item_dict_entry_t	*entry, entry_local;
+
+	if (NULL != (entry = (item_dict_entry_t *)zbx_hashset_search(&item_dicts[slot].itemids, &itemid))){
+		entry->item_type = item_type;
+		entry->defined = now;
+		return;
+	}
+
+	entry_local.itemid = itemid;
+	entry_local.item_type = item_type;
+	entry_local.defined = now;
+	zbx_hashset_insert(&item_dicts[slot].itemids, &entry_local, sizeof(entry_local));
+}
+
+
+/*********************************************************************
+ * item_dict_written                                                 *
+ *   Remember the file size after our records were flushed, so that  *
+ *   a later truncation can be told apart from appends by others.    *
+ *********************************************************************/
+void     item_dict_written(int slot, FILE *f)
+{
+	struct stat	st;
+
+	if (0 == fstat(fileno(f), &st)){
+		item_dicts[slot].size = st.st_size;
+	}
+}
+
+
+/*********************************************************************
+ * item_dict_invalidate                                              *
+ *   Forget the file, so the next item_dict_sync() resets the slot.  *
+ *   Used when our records may not have reached the file.            *
+ *********************************************************************/
+void     item_dict_invalidate(int slot)
+{
+	item_dict_t	*dict = &item_dicts[slot];
+
+	if (0 != dict->created){
+		zbx_hashset_clear(&dict->itemids);
+	}
+	zbx_free(dict->filename);
+}
+
+
+void     item_dict_destroy(void)
+{
+	int	i;
+
+	for (i = 0; i < ITEM_DICT_SLOT_NUM; i++){
+		if (0 != item_dicts[i].created){
+			zbx_hashset_destroy(&item_dicts[i].itemids);
+			item_dicts[i].created = 0;
+		}
+		zbx_free(item_dicts[i].filename);
+	}
+}
@@ -0,0 +1,33 @@
+#ifndef __ZABBIX_ITEM_DICT_H
+#define __ZABBIX_ITEM_DICT_H
+
+
+#include "sysinc.h"
+#include "module.h"
+#include "common.h"
+#include "log.h"
+#include "zbxalgo.h"
+#include "zbxjson.h"
+
+/* one dictionary per output file this process may keep writing to, */
+/* indexed by item value type, or 0 when files are not split by type */
+#define ITEM_DICT_SLOT_NUM 6
+
+/* header record starting every file written with the item dictionary */
+#define ITEM_DICT_TAG_HEAD "history2json"
+#define ITEM_DICT_HEAD_LEN 128
+
+/* item_dict_sync() reads the file head with pread(), which fails with */
+/* EBADF on the write-only descriptor of fopen(, "a")                  */
+#define ITEM_DICT_FOPEN_MODE "a+"
+
+
+extern void item_dict_sync(int slot, const char *filename, FILE *f);
+extern int  item_dict_exists(int slot, zbx_uint64_t itemid, int item_type, time_t now);
+extern void item_dict_add(int slot, zbx_uint64_t itemid, int item_type, time_t now);
+extern void item_dict_written(int slot, FILE *f);
+extern void item_dict_invalidate(int slot);
+extern void item_dict_destroy(void);
+
+
+#endif /* __ZABBIX_ITEM_DICT_H */
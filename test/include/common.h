@@ -0,0 +1,36 @@
+#ifndef __H2J_TEST_COMMON_H
+#define __H2J_TEST_COMMON_H
+
+#include "sysinc.h"
+
+#define SUCCEED		0
+#define FAIL		-1
+
+#define ZBX_PROTO_TAG_CLOCK	"clock"
+#define ZBX_PROTO_TAG_NS	"ns"
+
+typedef struct
+{
+	int	sec;
+	int	ns;
+}
+zbx_timespec_t;
+
+void		zbx_timespec(zbx_timespec_t *ts);
+char		*zbx_strdup(char *old, const char *str);
+size_t		zbx_snprintf(char *str, size_t count, const char *fmt, ...);
+const char	*zbx_strerror(int errnum);
+
+#define zbx_free(ptr)		\
+				\
+do				\
+{				\
+	if (ptr)		\
+	{			\
+		free(ptr);	\
+		ptr = NULL;	\
+	}			\
+}				\
+while (0)
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef __H2J_TEST_LOG_H
+#define __H2J_TEST_LOG_H
+
+#define LOG_LEVEL_WARNING	3
+#define LOG_LEVEL_DEBUG		4
+
+void	zabbix_log(int level, const char *fmt, ...);
+
+#endif
@@ -0,0 +1 @@
+/* empty: not used by the code under test */
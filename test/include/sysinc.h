@@ -0,0 +1,19 @@
+#ifndef __H2J_TEST_SYSINC_H
+#define __H2J_TEST_SYSINC_H
+
+/* minimal stand-ins for the Zabbix headers used by src/item_dict.c, */
+/* so that it can be tested without a zabbix source tree             */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <stdint.h>
+
+typedef uint64_t zbx_uint64_t;
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef __H2J_TEST_ZBXALGO_H
+#define __H2J_TEST_ZBXALGO_H
+
+#include "sysinc.h"
+
+/* linear stand-in for zbx_hashset_t keyed by a leading zbx_uint64_t */
+typedef struct
+{
+	char	*data;
+	size_t	elem_size;
+	size_t	num;
+	size_t	alloc;
+}
+zbx_hashset_t;
+
+#define ZBX_DEFAULT_UINT64_HASH_FUNC	NULL
+#define ZBX_DEFAULT_UINT64_COMPARE_FUNC	NULL
+
+void	zbx_hashset_create(zbx_hashset_t *hs, size_t init_size, void *hash_func, void *compare_func);
+void	*zbx_hashset_search(zbx_hashset_t *hs, const void *data);
+void	*zbx_hashset_insert(zbx_hashset_t *hs, const void *data, size_t size);
+void	zbx_hashset_clear(zbx_hashset_t *hs);
+void	zbx_hashset_destroy(zbx_hashset_t *hs);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef __H2J_TEST_ZBXJSON_H
+#define __H2J_TEST_ZBXJSON_H
+
+#include "sysinc.h"
+
+#define ZBX_JSON_STAT_BUF_LEN	4096
+
+struct zbx_json
+{
+	char	*buffer;
+	size_t	buffer_size;
+	size_t	buffer_offset;
+	int	need_comma;
+};
+
+void	zbx_json_init(struct zbx_json *j, size_t allocate);
+void	zbx_json_addobject(struct zbx_json *j, const char *name);
+void	zbx_json_adduint64(struct zbx_json *j, const char *tag, zbx_uint64_t value);
+void	zbx_json_close(struct zbx_json *j);
+void	zbx_json_free(struct zbx_json *j);
+
+#endif
@@ -0,0 +1,162 @@
+/*
+ * item_dict_test: file identity checks of src/item_dict.c on real files.
+ *
+ * Each dictionary slot stands for one history syncer writing the same file,
+ * and every batch() mirrors history2json_general_cb(): open, flock, sync,
+ * write definition/value records, flush, record the size, unlock, close.
+ */
+
+#include <sys/file.h>
+
+#include "item_dict.h"
+#include "config_load.h"
+
+int	CONFIG_JSON_OUTPUT_DICTIONARY_TTL = 600;
+
+#define SYNCER_A	1
+#define SYNCER_B	2
+
+#define HEAD_PREFIX	"{\"" ITEM_DICT_TAG_HEAD "\":{\"pid\":"
+
+#define ITEM_FLOAT	1
+#define ITEM_INTEGER	2
+
+static int	failures = 0;
+
+#define CHECK(cond, msg)							\
+do										\
+{										\
+	if (!(cond))								\
+	{									\
+		fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, msg);	\
+		failures++;							\
+	}									\
+	else									\
+		printf("ok   %s\n", msg);					\
+}										\
+while (0)
+
+/* writes one value of itemid, preceded by its definition when the slot has none; */
+/* returns SUCCEED when a definition was written                                  */
+static int	batch(int slot, const char *filename, zbx_uint64_t itemid, int item_type, time_t now)
+{
+	FILE	*f;
+	int	defined = FAIL;
+
+	if (NULL == (f = fopen(filename, ITEM_DICT_FOPEN_MODE)) || 0 != flock(fileno(f), LOCK_EX)){
+		perror(filename);
+		exit(EXIT_FAILURE);
+	}
+
+	item_dict_sync(slot, filename, f);
+
+	if (SUCCEED != item_dict_exists(slot, itemid, item_type, now)){
+		fprintf(f, "{\"definition\":{\"itemid\":%llu,\"host\":\"h\"}}\n", (unsigned long long)itemid);
+		item_dict_add(slot, itemid, item_type, now);
+		defined = SUCCEED;
+	}
+
+	fprintf(f, "{\"pid\":%d,\"itemid\":%llu,\"clock\":%ld,\"ns\":0,\"value\":\"%064d\"}\n",
+	        slot, (unsigned long long)itemid, (long)now, 0);
+
+	if (0 != fflush(f))
+		item_dict_invalidate(slot);
+	else
+		item_dict_written(slot, f);
+
+	flock(fileno(f), LOCK_UN);
+	fclose(f);
+
+	return defined;
+}
+
+static off_t	file_size(const char *filename)
+{
+	struct stat	st;
+
+	return 0 == stat(filename, &st) ? st.st_size : -1;
+}
+
+/* other syncer appends until the file is larger than "size" */
+static void	refill(int slot, const char *filename, off_t size, time_t now)
+{
+	while (file_size(filename) <= size)
+		batch(slot, filename, 99, ITEM_FLOAT, now);
+}
+
+int	main(void)
+{
+	char	dir[] = "/tmp/h2j_item_dict_XXXXXX";
+	char	filename[64], other[64], rotated[64], line[256];
+	time_t	now = time(NULL);
+	off_t	size;
+	FILE	*f;
+
+	if (NULL == mkdtemp(dir)){
+		perror("mkdtemp");
+		return EXIT_FAILURE;
+	}
+
+	snprintf(filename, sizeof(filename), "%s/history.json", dir);
+	snprintf(other, sizeof(other), "%s/history.json.other", dir);
+	snprintf(rotated, sizeof(rotated), "%s/history.json.1", dir);
+
+	/* empty file */
+	CHECK(SUCCEED == batch(SYNCER_A, filename, 1, ITEM_FLOAT, now), "empty file: item is defined");
+
+	f = fopen(filename, "r");
+	CHECK(NULL != f && NULL != fgets(line, sizeof(line), f) &&
+	      0 == strncmp(line, HEAD_PREFIX, strlen(HEAD_PREFIX)),
+	      "empty file: starts with the header record");
+	if (NULL != f)
+		fclose(f);
+
+	CHECK(FAIL == batch(SYNCER_A, filename, 1, ITEM_FLOAT, now), "same file: header read back, no reset");
+
+	/* appends by another syncer */
+	CHECK(SUCCEED == batch(SYNCER_B, filename, 1, ITEM_FLOAT, now), "other syncer: defines on its own");
+	CHECK(FAIL == batch(SYNCER_A, filename, 1, ITEM_FLOAT, now), "other syncer appended: no reset");
+
+	/* copytruncate, refilled by another syncer past our last size */
+	size = file_size(filename);
+	CHECK(0 == truncate(filename, 0), "truncate");
+	refill(SYNCER_B, filename, size, now);
+	CHECK(file_size(filename) > size, "truncated file refilled past old size");
+	CHECK(SUCCEED == batch(SYNCER_A, filename, 1, ITEM_FLOAT, now), "truncated and refilled: reset");
+	CHECK(FAIL == batch(SYNCER_A, filename, 1, ITEM_FLOAT, now), "after truncation: no further reset");
+
+	/* rename rotation, new inode refilled by another syncer */
+	size = file_size(filename);
+	CHECK(0 == rename(filename, rotated), "rename");
+	refill(SYNCER_B, filename, size, now);
+	CHECK(SUCCEED == batch(SYNCER_A, filename, 1, ITEM_FLOAT, now), "new inode: reset");
+
+	/* file name change (date/type split) */
+	CHECK(SUCCEED == batch(SYNCER_A, other, 1, ITEM_FLOAT, now), "new file name: reset");
+	CHECK(SUCCEED == batch(SYNCER_A, filename, 1, ITEM_FLOAT, now), "previous file name: reset");
+
+	/* value type change and TTL */
+	CHECK(SUCCEED == batch(SYNCER_A, filename, 1, ITEM_INTEGER, now), "value type changed: defined");
+	CHECK(FAIL == batch(SYNCER_A, filename, 1, ITEM_INTEGER, now + CONFIG_JSON_OUTPUT_DICTIONARY_TTL - 1),
+	      "before TTL: not defined");
+	CHECK(SUCCEED == batch(SYNCER_A, filename, 1, ITEM_INTEGER, now + CONFIG_JSON_OUTPUT_DICTIONARY_TTL),
+	      "TTL expired: defined");
+
+	/* failed flush */
+	item_dict_invalidate(SYNCER_A);
+	CHECK(SUCCEED == batch(SYNCER_A, filename, 1, ITEM_INTEGER, now), "invalidated: reset");
+
+	item_dict_destroy();
+
+	unlink(filename);
+	unlink(other);
+	unlink(rotated);
+	rmdir(dir);
+
+	if (0 != failures){
+		fprintf(stderr, "%d check(s) failed\n", failures);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
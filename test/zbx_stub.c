@@ -0,0 +1,144 @@
+/*
+ * stand-in implementations of the Zabbix functions used by src/item_dict.c
+ */
+
+#include <stdarg.h>
+
+#include "common.h"
+#include "log.h"
+#include "zbxalgo.h"
+#include "zbxjson.h"
+
+void	zbx_timespec(zbx_timespec_t *ts)
+{
+	struct timespec	tp;
+
+	clock_gettime(CLOCK_REALTIME, &tp);
+	ts->sec = (int)tp.tv_sec;
+	ts->ns = (int)tp.tv_nsec;
+}
+
+char	*zbx_strdup(char *old, const char *str)
+{
+	free(old);
+	return strdup(str);
+}
+
+size_t	zbx_snprintf(char *str, size_t count, const char *fmt, ...)
+{
+	va_list	args;
+	int	n;
+
+	va_start(args, fmt);
+	n = vsnprintf(str, count, fmt, args);
+	va_end(args);
+
+	return (0 > n || (size_t)n >= count) ? count - 1 : (size_t)n;
+}
+
+const char	*zbx_strerror(int errnum)
+{
+	return strerror(errnum);
+}
+
+void	zabbix_log(int level, const char *fmt, ...)
+{
+	va_list	args;
+
+	if (LOG_LEVEL_WARNING < level && NULL == getenv("H2J_TEST_DEBUG"))
+		return;
+
+	va_start(args, fmt);
+	vfprintf(stderr, fmt, args);
+	va_end(args);
+	fputc('\n', stderr);
+}
+
+void	zbx_hashset_create(zbx_hashset_t *hs, size_t init_size, void *hash_func, void *compare_func)
+{
+	(void)hash_func;
+	(void)compare_func;
+
+	hs->data = NULL;
+	hs->elem_size = 0;
+	hs->num = 0;
+	hs->alloc = init_size;
+}
+
+void	*zbx_hashset_search(zbx_hashset_t *hs, const void *data)
+{
+	size_t	i;
+
+	for (i = 0; i < hs->num; i++){
+		if (0 == memcmp(hs->data + i * hs->elem_size, data, sizeof(zbx_uint64_t)))
+			return hs->data + i * hs->elem_size;
+	}
+
+	return NULL;
+}
+
+void	*zbx_hashset_insert(zbx_hashset_t *hs, const void *data, size_t size)
+{
+	void	*entry;
+
+	if (NULL != (entry = zbx_hashset_search(hs, data)))
+		return entry;
+
+	if (NULL == hs->data || hs->num == hs->alloc){
+		hs->alloc = 0 == hs->alloc ? 8 : hs->alloc * 2;
+		hs->data = realloc(hs->data, hs->alloc * size);
+	}
+
+	hs->elem_size = size;
+	entry = hs->data + hs->num++ * size;
+	memcpy(entry, data, size);
+
+	return entry;
+}
+
+void	zbx_hashset_clear(zbx_hashset_t *hs)
+{
+	hs->num = 0;
+}
+
+void	zbx_hashset_destroy(zbx_hashset_t *hs)
+{
+	free(hs->data);
+	hs->data = NULL;
+	hs->num = 0;
+	hs->alloc = 0;
+}
+
+void	zbx_json_init(struct zbx_json *j, size_t allocate)
+{
+	j->buffer = malloc(allocate);
+	j->buffer_size = allocate;
+	j->buffer_offset = zbx_snprintf(j->buffer, allocate, "{");
+	j->need_comma = 0;
+}
+
+void	zbx_json_addobject(struct zbx_json *j, const char *name)
+{
+	j->buffer_offset += zbx_snprintf(j->buffer + j->buffer_offset, j->buffer_size - j->buffer_offset,
+	                                 "%s\"%s\":{", j->need_comma ? "," : "", name);
+	j->need_comma = 0;
+}
+
+void	zbx_json_adduint64(struct zbx_json *j, const char *tag, zbx_uint64_t value)
+{
+	j->buffer_offset += zbx_snprintf(j->buffer + j->buffer_offset, j->buffer_size - j->buffer_offset,
+	                                 "%s\"%s\":%llu", j->need_comma ? "," : "", tag,
+	                                 (unsigned long long)value);
+	j->need_comma = 1;
+}
+
+void	zbx_json_close(struct zbx_json *j)
+{
+	j->buffer_offset += zbx_snprintf(j->buffer + j->buffer_offset, j->buffer_size - j->buffer_offset, "}");
+	j->need_comma = 1;
+}
+
+void	zbx_json_free(struct zbx_json *j)
+{
+	zbx_free(j->buffer);
+}
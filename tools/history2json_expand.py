@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+#
+# Re-expand history2json output written with JSONOutputItemDictionary=1
+# to the per-value format (host/item infomation in every record).
+#
+# usage: history2json_expand.py [FILE ...]   (reads stdin when no FILE)
+#
+# Records are spliced as text and never re-serialised, so values keep the
+# module's formatting ("0.250000", "\/" escapes) byte for byte:
+#
+#   {"definition":{"itemid":23,"hostid":10084,...,"key":"k"}}
+#   {"pid":12,"itemid":23,"clock":...}
+#     -> {"pid":12,"hostid":10084,...,"key":"k","itemid":23,"clock":...}
+#
+# A file may hold several definitions of one itemid (one per history syncer,
+# and again after JSONOutputItemDictionaryTTL); the latest one wins.
+# Each file is expanded with its own dictionary. The {"history2json":..}
+# header record starting each file is dropped.
+
+import re
+import sys
+
+HEAD_RE = re.compile(r'^\{"history2json":\{')
+DEFINITION_RE = re.compile(r'^\{"definition":\{"itemid":(\d+),(.*)\}\}$')
+VALUE_RE = re.compile(r'^\{("pid":\d+,)?"itemid":(\d+)(,.*)$')
+
+
+def expand(lines, out, name="-"):
+    items = {}
+
+    for lineno, line in enumerate(lines, 1):
+        line = line.rstrip("\n")
+        if not line:
+            continue
+
+        if HEAD_RE.match(line):
+            continue
+
+        m = DEFINITION_RE.match(line)
+        if m:
+            items[m.group(1)] = m.group(2)
+            continue
+
+        m = VALUE_RE.match(line)
+        if m is None:
+            out.write(line + "\n")
+            continue
+
+        fields = items.get(m.group(2))
+        if fields is None:
+            sys.stderr.write("%s:%d: no definition for itemid %s\n"
+                             % (name, lineno, m.group(2)))
+            out.write(line + "\n")
+            continue
+
+        out.write('{%s%s,"itemid":%s%s\n'
+                  % (m.group(1) or "", fields, m.group(2), m.group(3)))
+
+
+def main():
+    if len(sys.argv) < 2:
+        expand(sys.stdin, sys.stdout)
+        return
+
+    for filename in sys.argv[1:]:
+        with open(filename, encoding="utf-8", newline="\n") as f:
+            expand(f, sys.stdout, filename)
+
+
+if __name__ == "__main__":
+    main()